@@ -0,0 +1,127 @@
+/* A bounded SPSC ring in the style of B-Queue (https://doi.org/10.1007/s10766-012-0213-x)
+   and FastForward (https://doi.org/10.1145/1345206.1345215).
+
+   Unlike CircularBuffer, producer and consumer never read each other's
+   indices. Every slot carries a full / empty marker and each side only keeps
+   a private index plus a private batch boundary. When a side runs out of
+   batch it probes the slot BatchSize ahead: if that slot is ready then every
+   slot before it is too (slots are filled and drained in order), so the next
+   BatchSize operations touch no shared state except the slots themselves.
+   If the probe fails the batch is halved (backtracking) down to a single slot.
+
+   [full?, value] [full?, value] ... [full?, value]
+    ^ consumer head                   ^ producer tail */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+
+template<typename NodeType, size_t Size, size_t BatchSize = 16>
+class BatchQueue {
+public:
+    enum {
+        Capacity    = Size,
+        Batch       = BatchSize < Size ? BatchSize : Size,
+        CacheLine   = 64
+    };
+    static_assert(Size > 0, "BatchQueue requires at least one slot");
+    static_assert(BatchSize > 0, "BatchQueue requires a non-zero batch size");
+
+    BatchQueue(): _tail{0}, _batch_tail{0}, _head{0}, _batch_head{0} {}
+    virtual ~BatchQueue() {}
+
+    /* PRODUCER METHOD: Marks slot full *after* placing element into it */
+    bool enqueue(const NodeType& value)
+    {
+        if (_tail == _batch_tail && !probe_producer_batch())
+            return false; // full
+
+        Slot& slot = _array[_tail];
+        slot.value = value;
+        slot.full.store(true, std::memory_order_release);
+        _tail = increment(_tail);
+        return true;
+    }
+
+    /* CONSUMER MEHOD: Marks slot empty *after* removing element from it */
+    bool dequeue(NodeType& value)
+    {
+        if (_head == _batch_head && !probe_consumer_batch())
+            return false; // empty
+
+        Slot& slot = _array[_head];
+        value = slot.value;
+        slot.full.store(false, std::memory_order_release);
+        _head = increment(_head);
+        return true;
+    }
+
+    /* CONSUMER MEHOD: Dequeues node without returning a value */
+    bool pop()
+    {
+        NodeType value;
+        return dequeue(value);
+    }
+
+    /* CONSUMER MEHOD: Returns a pointer to head *without* dequeueing it */
+    NodeType* peek()
+    {
+        if (is_empty())
+            return nullptr;
+
+        return &_array[_head].value;
+    }
+
+    /* Snapshot of empty (consumer side) and full (producer side) status */
+    bool is_empty() { return !_array[_head].full.load(std::memory_order_acquire); }
+    bool is_full()  { return _array[_tail].full.load(std::memory_order_acquire); }
+
+private:
+    struct Slot {
+        std::atomic<bool> full{false};
+        NodeType value;
+    };
+
+    size_t increment(size_t idx) const { return (idx + 1) % Capacity; }
+    size_t advance(size_t idx, size_t n) const { return (idx + n) % Capacity; }
+
+    /* PRODUCER METHOD: Finds the furthest empty slot within a batch. An empty
+       slot means the consumer has drained every slot before it as well. */
+    bool probe_producer_batch()
+    {
+        for (size_t batch = Batch; batch > 0; batch /= 2)
+        {
+            if (!_array[advance(_tail, batch - 1)].full.load(std::memory_order_acquire))
+            {
+                _batch_tail = advance(_tail, batch);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* CONSUMER METHOD: Finds the furthest full slot within a batch. A full
+       slot means the producer has filled every slot before it as well. */
+    bool probe_consumer_batch()
+    {
+        for (size_t batch = Batch; batch > 0; batch /= 2)
+        {
+            if (_array[advance(_head, batch - 1)].full.load(std::memory_order_acquire))
+            {
+                _batch_head = advance(_head, batch);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Slot _array[Capacity];
+
+    // producer and consumer state live on separate cache lines
+    alignas(CacheLine) size_t _tail;
+    size_t _batch_tail;
+    alignas(CacheLine) size_t _head;
+    size_t _batch_head;
+};
@@ -11,9 +11,13 @@
 #include <iostream>
 #include <random>
 #include <thread>
+#include <vector>
 
 #include "../readerwriter_queue.h"
 #include "../circular_buffer.h"
+#include "../batch_queue.h"
+#include "../priority_circular_buffer.h"
+#include "../multi_producer_circular_buffer.h"
 #include "time.cc"
 
 
@@ -28,9 +32,19 @@ enum BenchmarkType {
 
 const int LONGEST_BENCHMARK_NAME = 16;
 
+/* Benchmarks only call enqueue(value)-pin all priority queue traffic to its
+   lowest priority lane so the per-enqueue fence / summary cost shows up */
+template<typename Q, size_t Lane>
+class SingleLane : public Q {
+public:
+    bool enqueue(const int& value) { return Q::enqueue(value, Lane); }
+};
+
 template<typename Q>
 double runBenchmark(BenchmarkType benchmark, double& opsPerIter);
 const char* benchmarkName(BenchmarkType benchmark);
+template<typename Q>
+double runFanInBenchmark(int producers, double& opsPerIter);
 
 int main(int argc, char**argv)
 {
@@ -39,9 +53,13 @@ int main(int argc, char**argv)
 
     double spscResults[BENCHMARKS_TOTAL][ITER];
     double circBufferResults[BENCHMARKS_TOTAL][ITER];
+    double batchQueueResults[BENCHMARKS_TOTAL][ITER];
+    double prioBufferResults[BENCHMARKS_TOTAL][ITER];
 
     double spscOps[BENCHMARKS_TOTAL][ITER];
     double circBufferOps[BENCHMARKS_TOTAL][ITER];
+    double batchQueueOps[BENCHMARKS_TOTAL][ITER];
+    double prioBufferOps[BENCHMARKS_TOTAL][ITER];
 
     for (int benchmark = 0; benchmark < BENCHMARKS_TOTAL; ++benchmark)
     {
@@ -49,6 +67,8 @@ int main(int argc, char**argv)
         {
             spscResults[benchmark][i] = runBenchmark<NonBlockingQueue<int>>((BenchmarkType) benchmark, spscOps[benchmark][i]);
             circBufferResults[benchmark][i] = runBenchmark<CircularBuffer<int, 100>>((BenchmarkType) benchmark, circBufferOps[benchmark][i]);
+            batchQueueResults[benchmark][i] = runBenchmark<BatchQueue<int, 100>>((BenchmarkType) benchmark, batchQueueOps[benchmark][i]);
+            prioBufferResults[benchmark][i] = runBenchmark<SingleLane<PriorityCircularBuffer<int, 100, 4>, 3>>((BenchmarkType) benchmark, prioBufferOps[benchmark][i]);
         }
     }
 
@@ -57,33 +77,45 @@ int main(int argc, char**argv)
     {
         std::sort(&spscResults[benchmark][0], &spscResults[benchmark][ITER - 1]);
         std::sort(&circBufferResults[benchmark][0], &circBufferResults[benchmark][ITER - 1]);
+        std::sort(&batchQueueResults[benchmark][0], &batchQueueResults[benchmark][ITER - 1]);
+        std::sort(&prioBufferResults[benchmark][0], &prioBufferResults[benchmark][ITER - 1]);
     }
 
     int max = std::max(2, (int)(ITER * FASTEST_PERCENT_CONSIDERED / 100));
     assert(max > 0);
 
     // build header for results table
-    std::cout              << std::setw(LONGEST_BENCHMARK_NAME) << "         " << " |------ Min ------|------ Max ------|------ Avg ------|\n";
-    std::cout << std::left << std::setw(LONGEST_BENCHMARK_NAME) << "Benchmark" << " |  SPSC  |  CIRC  |  SPSC  |  CIRC  |  SPSC  |  CIRC  |\n";
+    std::cout              << std::setw(LONGEST_BENCHMARK_NAME) << "         " << " |-------------- Min --------------|-------------- Max --------------|-------------- Avg --------------|\n";
+    std::cout << std::left << std::setw(LONGEST_BENCHMARK_NAME) << "Benchmark" << " |  SPSC  |  CIRC  |  BATCH |  PRIO  |  SPSC  |  CIRC  |  BATCH |  PRIO  |  SPSC  |  CIRC  |  BATCH |  PRIO  |\n";
     std::cout.fill('-');
-    std::cout              << std::setw(LONGEST_BENCHMARK_NAME) << "---------" << "-+--------+--------+--------+--------+--------+--------+\n";
+    std::cout              << std::setw(LONGEST_BENCHMARK_NAME) << "---------" << "-+--------+--------+--------+--------+--------+--------+--------+--------+--------+--------+--------+--------+\n";
     std::cout.fill(' ');
 
     // find min and max averages
     double spscOpsPerSec        = 0;
     double circBufferOpsPerSec  = 0;
+    double batchQueueOpsPerSec  = 0;
+    double prioBufferOpsPerSec  = 0;
     int opTimedBenchmarks       = 0;
     for (int benchmark = 0; benchmark < BENCHMARKS_TOTAL; benchmark++)
     {
         double spscMin = spscResults[benchmark][0], spscMax = spscResults[benchmark][max - 1];
         double circMin = circBufferResults[benchmark][0], circMax = circBufferResults[benchmark][max - 1];
+        double batchMin = batchQueueResults[benchmark][0], batchMax = batchQueueResults[benchmark][max - 1];
+        double prioMin = prioBufferResults[benchmark][0], prioMax = prioBufferResults[benchmark][max - 1];
         double spscAvg = std::accumulate(&spscResults[benchmark][0], &spscResults[benchmark][0] + max, 0.0) / max;
         double circAvg = std::accumulate(&circBufferResults[benchmark][0], &circBufferResults[benchmark][0] + max, 0.0) / max;
+        double batchAvg = std::accumulate(&batchQueueResults[benchmark][0], &batchQueueResults[benchmark][0] + max, 0.0) / max;
+        double prioAvg = std::accumulate(&prioBufferResults[benchmark][0], &prioBufferResults[benchmark][0] + max, 0.0) / max;
 
         double spscTotalAvg = std::accumulate(&spscResults[benchmark][0], &spscResults[benchmark][0] + ITER, 0.0) / ITER;
         double circTotalAvg = std::accumulate(&circBufferResults[benchmark][0], &circBufferResults[benchmark][0] + ITER, 0.0) / ITER;
+        double batchTotalAvg = std::accumulate(&batchQueueResults[benchmark][0], &batchQueueResults[benchmark][0] + ITER, 0.0) / ITER;
+        double prioTotalAvg = std::accumulate(&prioBufferResults[benchmark][0], &prioBufferResults[benchmark][0] + ITER, 0.0) / ITER;
         spscOpsPerSec       += spscTotalAvg == 0 ? 0 : std::accumulate(&spscOps[benchmark][0], &spscOps[benchmark][0] + ITER, 0.0) / ITER / spscTotalAvg;
         circBufferOpsPerSec += circTotalAvg == 0 ? 0 : std::accumulate(&circBufferOps[benchmark][0], &circBufferOps[benchmark][0] + ITER, 0.0) / ITER / circTotalAvg;
+        batchQueueOpsPerSec += batchTotalAvg == 0 ? 0 : std::accumulate(&batchQueueOps[benchmark][0], &batchQueueOps[benchmark][0] + ITER, 0.0) / ITER / batchTotalAvg;
+        prioBufferOpsPerSec += prioTotalAvg == 0 ? 0 : std::accumulate(&prioBufferOps[benchmark][0], &prioBufferOps[benchmark][0] + ITER, 0.0) / ITER / prioTotalAvg;
 
         ++opTimedBenchmarks;
 
@@ -91,22 +123,85 @@ int main(int argc, char**argv)
             << std::left << std::setw(LONGEST_BENCHMARK_NAME) << benchmarkName((BenchmarkType)benchmark) << " | "
             << std::fixed << std::setprecision(3) << spscMin << "s | "
             << std::fixed << std::setprecision(3) << circMin << "s | "
+            << std::fixed << std::setprecision(3) << batchMin << "s | "
+            << std::fixed << std::setprecision(3) << prioMin << "s | "
             << std::fixed << std::setprecision(3) << spscMax << "s | "
             << std::fixed << std::setprecision(3) << circMax << "s | "
+            << std::fixed << std::setprecision(3) << batchMax << "s | "
+            << std::fixed << std::setprecision(3) << prioMax << "s | "
             << std::fixed << std::setprecision(3) << spscAvg << "s | "
             << std::fixed << std::setprecision(3) << circAvg << "s | "
+            << std::fixed << std::setprecision(3) << batchAvg << "s | "
+            << std::fixed << std::setprecision(3) << prioAvg << "s | "
             << "\n";
     }
 
     spscOpsPerSec       /= opTimedBenchmarks;
     circBufferOpsPerSec /= opTimedBenchmarks;
+    batchQueueOpsPerSec /= opTimedBenchmarks;
+    prioBufferOpsPerSec /= opTimedBenchmarks;
     std::cout
         << "\nAverage ops/s:\n"
         << "    SPSC Queue:         " << std::fixed << std::setprecision(2) << spscOpsPerSec / 1000000 << " million\n"
         << "    Circular Buffer:    " << std::fixed << std::setprecision(2) << circBufferOpsPerSec / 1000000 << " million\n"
+        << "    Batch Queue:        " << std::fixed << std::setprecision(2) << batchQueueOpsPerSec / 1000000 << " million\n"
+        << "    Priority Buffer:    " << std::fixed << std::setprecision(2) << prioBufferOpsPerSec / 1000000 << " million\n"
     ;
     std::cout << std::endl;
 
+    // fan-in: scale producer count into a single consumer, SPSC ring only
+    // supports a single producer so it is the 1 producer baseline
+    const int MAX_PRODUCERS = std::max(2, (int) std::thread::hardware_concurrency() - 1);
+
+    std::cout              << std::setw(LONGEST_BENCHMARK_NAME) << "         " << " |------ Avg ------|-- Million ops/s -|\n";
+    std::cout << std::left << std::setw(LONGEST_BENCHMARK_NAME) << "Fan-in producers" << " |  MPSC  |  SPSC  |  MPSC  |  SPSC  |\n";
+    std::cout.fill('-');
+    std::cout              << std::setw(LONGEST_BENCHMARK_NAME) << "---------" << "-+--------+--------+--------+--------+\n";
+    std::cout.fill(' ');
+
+    for (int producers = 1; ; producers = std::min(producers * 2, MAX_PRODUCERS))
+    {
+        double mpscFanInResults[ITER];
+        double spscFanInResults[ITER];
+        double mpscFanInOps[ITER];
+        double spscFanInOps[ITER];
+        for (int i = 0; i < ITER; ++i)
+        {
+            mpscFanInResults[i] = runFanInBenchmark<MultiProducerCircularBuffer<int, 100>>(producers, mpscFanInOps[i]);
+            spscFanInResults[i] = spscFanInOps[i] = 0;
+            if (producers == 1)
+                spscFanInResults[i] = runFanInBenchmark<CircularBuffer<int, 100>>(producers, spscFanInOps[i]);
+        }
+        std::sort(&mpscFanInResults[0], &mpscFanInResults[ITER - 1]);
+        std::sort(&spscFanInResults[0], &spscFanInResults[ITER - 1]);
+
+        double mpscAvg = std::accumulate(&mpscFanInResults[0], &mpscFanInResults[0] + max, 0.0) / max;
+        double spscAvg = std::accumulate(&spscFanInResults[0], &spscFanInResults[0] + max, 0.0) / max;
+
+        double mpscTotalAvg = std::accumulate(&mpscFanInResults[0], &mpscFanInResults[0] + ITER, 0.0) / ITER;
+        double spscTotalAvg = std::accumulate(&spscFanInResults[0], &spscFanInResults[0] + ITER, 0.0) / ITER;
+        double mpscOpsPerSec = mpscTotalAvg == 0 ? 0 : std::accumulate(&mpscFanInOps[0], &mpscFanInOps[0] + ITER, 0.0) / ITER / mpscTotalAvg;
+        double spscOpsPerSec = spscTotalAvg == 0 ? 0 : std::accumulate(&spscFanInOps[0], &spscFanInOps[0] + ITER, 0.0) / ITER / spscTotalAvg;
+
+        std::cout
+            << std::left << std::setw(LONGEST_BENCHMARK_NAME) << producers << " | "
+            << std::fixed << std::setprecision(3) << mpscAvg << "s | ";
+        if (producers == 1)
+            std::cout << std::fixed << std::setprecision(3) << spscAvg << "s | ";
+        else
+            std::cout << "   -   | ";
+        std::cout << std::right << std::setw(6) << std::fixed << std::setprecision(2) << mpscOpsPerSec / 1000000 << " | ";
+        if (producers == 1)
+            std::cout << std::right << std::setw(6) << std::fixed << std::setprecision(2) << spscOpsPerSec / 1000000 << " | ";
+        else
+            std::cout << "   -   | ";
+        std::cout << "\n";
+
+        if (producers == MAX_PRODUCERS)
+            break;
+    }
+    std::cout << std::endl;
+
     return 0;
 }
 
@@ -218,6 +313,43 @@ double runBenchmark(BenchmarkType benchmark, double& opsPerIter)
     return result / 1000.0;
 }
 
+template<typename Q>
+double runFanInBenchmark(int producers, double& opsPerIter)
+{
+    const int MAX = 200 * 1000;
+    opsPerIter = MAX * 2;
+
+    Q queue;
+    TimePoint start = getTimePoint();
+    std::vector<std::thread> producerThreads;
+    for (int p = 0; p != producers; ++p)
+    {
+        producerThreads.emplace_back([&, p]() {
+            // split MAX evenly, first producers pick up the remainder. Yield
+            // on full / empty so oversubscribed cores still make progress
+            const int count = MAX / producers + (p < MAX % producers ? 1 : 0);
+            for (int i = 0; i != count; ++i)
+            {
+                while (!queue.enqueue(i))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    int element = -1;
+    for (int i = 0; i != MAX; ++i)
+    {
+        while (!queue.dequeue(element))
+            std::this_thread::yield();
+    }
+    for (auto& producer : producerThreads)
+    {
+        producer.join();
+    }
+
+    return getTimeDelta(start) / 1000.0;
+}
+
 const char* benchmarkName(BenchmarkType benchmark)
 {
     switch (benchmark) {
@@ -1,6 +1,8 @@
 /* A simple circular buffer that uses refined-memory ordered reads / writes.
    Producer thread will only update tail and Consumer will only update head. */
 
+#pragma once
+
 #include <atomic>
 #include <cstddef>
 
@@ -0,0 +1,141 @@
+/* An unbounded intrusive MPSC queue based on D.Vyukov's non-intrusive / intrusive
+   node-based queue (https://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue).
+
+   Elements embed an IntrusiveNode hook so the queue never allocates or copies
+   anything-enqueue / dequeue simply link and unlink the caller's objects.
+   Producers only perform a single atomic exchange on the tail, so any number
+   of producers may enqueue concurrently. A single consumer walks from the
+   head. The queue owns a stub node that is re-linked whenever the last real
+   node is dequeued so the list is never empty.
+
+   Not strictly lock-free: a producer pre-empted between its exchange and its
+   link leaves later nodes invisible to the consumer until it resumes.
+
+   HEAD                                 TAIL
+   [stub / node, next*] -> ... -> [node, next*] */
+
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+
+/* Hook embedded (by inheritance) into every type stored in an IntrusiveQueue.
+   A node must stay alive and must not be enqueued twice while in a queue.
+   Copies never carry the link over so hooked types stay copyable / movable
+   (e.g. when a pool reallocates)-a copy always starts out unlinked. */
+struct IntrusiveNode
+{
+    std::atomic<IntrusiveNode*> next;
+
+    IntrusiveNode(): next{nullptr} {}
+    IntrusiveNode(const IntrusiveNode&): next{nullptr} {}
+
+    IntrusiveNode& operator=(const IntrusiveNode&)
+    {
+        // keep this node's own link-it may currently be in a queue
+        return *this;
+    }
+};
+
+template<typename T>
+class IntrusiveQueue
+{
+    static_assert(std::is_base_of_v<IntrusiveNode, T>, "T must derive from IntrusiveNode");
+
+public:
+    IntrusiveQueue(): _head{&_stub}, _tail{&_stub} {}
+
+    // nodes are owned by the caller-nothing to free
+    virtual ~IntrusiveQueue() {}
+
+    IntrusiveQueue(const IntrusiveQueue&)               = delete;
+    IntrusiveQueue& operator=(const IntrusiveQueue&)    = delete;
+
+    /* PRODUCER METHOD: Links node onto the back of the queue. Safe to call from
+       multiple producer threads. */
+    void enqueue(T* node)
+    {
+        link(static_cast<IntrusiveNode*>(node));
+    }
+
+     /* CONSUMER METHOD: Returns a pointer to the head *without* dequeuing it */
+    T* peek()
+    {
+        if (!skip_stub())
+            return nullptr;
+
+        return static_cast<T*>(_head);
+    }
+
+     /* CONSUMER METHOD: Unlinks the head node and hands it back to the caller */
+    bool dequeue(T*& result)
+    {
+        if (!skip_stub())
+            return false;
+
+        IntrusiveNode* head = _head;
+        IntrusiveNode* next = head->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            // head looks like the last node-if a producer has already swapped
+            // the tail it is mid-enqueue and we must wait for it to link
+            if (head != _tail.load(std::memory_order_acquire))
+                return false;
+
+            // re-link the stub behind the last node so it can be unlinked
+            link(&_stub);
+            next = head->next.load(std::memory_order_acquire);
+            if (next == nullptr)
+                return false;
+        }
+
+        _head   = next;
+        result  = static_cast<T*>(head);
+        return true;
+    }
+
+     /* CONSUMER METHOD: Dequeues a node from the front of the queue (head) but
+        does *not* return the dequeued node. */
+    bool pop()
+    {
+        T* result;
+        return dequeue(result);
+    }
+
+    /* CONSUMER METHOD: Snapshot of empty queue status */
+    bool is_empty()
+    {
+        return _head == &_stub && _tail.load(std::memory_order_acquire) == &_stub;
+    }
+
+private:
+    /* PRODUCER METHOD: Swaps node in as the new tail then links the old tail to it */
+    void link(IntrusiveNode* node)
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        IntrusiveNode* prev = _tail.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    /* CONSUMER METHOD: Moves head past the stub. Returns false if no real node
+       is visible yet. */
+    bool skip_stub()
+    {
+        if (_head != &_stub)
+            return true;
+
+        IntrusiveNode* next = _stub.next.load(std::memory_order_acquire);
+        if (next == nullptr)
+            return false;
+
+        _head = next;
+        return true;
+    }
+
+    IntrusiveNode _stub;
+
+    // only the consumer touches head so it does not need to be atomic
+    IntrusiveNode* _head;
+    std::atomic<IntrusiveNode*> _tail;
+};
@@ -0,0 +1,121 @@
+/* A bounded multi-producer single-consumer circular buffer based on D.Vyukov's
+   bounded MPMC queue (https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue).
+
+   Every slot carries a sequence number telling which lap of the ring it is
+   ready for. Producers claim a slot with a single CAS on the shared tail and
+   then publish it by bumping the slot sequence. There is only one consumer so
+   head is consumer-local and dequeue never touches the tail-it only checks
+   the slot sequence, same cost as CircularBuffer::dequeue.
+
+   slot.seq == pos         -> slot free for the producer claiming pos
+   slot.seq == pos + 1     -> slot holds the element at pos
+   slot.seq == pos + Size  -> slot drained, free for the next lap */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+template<typename NodeType, size_t Size>
+class MultiProducerCircularBuffer {
+public:
+    enum { Capacity = Size, CacheLine = 64 };
+    // with one slot a full slot's seq (pos + 1) equals the next producer's pos
+    // so it would be claimed and overwritten before it is consumed
+    static_assert(Size >= 2, "MultiProducerCircularBuffer requires at least two slots");
+
+    MultiProducerCircularBuffer(): _tail{0}, _head{0}
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+            _array[i].seq.store(i, std::memory_order_relaxed);
+    }
+    virtual ~MultiProducerCircularBuffer() {}
+
+    /* PRODUCER METHOD: Claims a slot via CAS on tail then publishes it through
+       the slot sequence. Safe to call from multiple producer threads. */
+    bool enqueue(const NodeType& value)
+    {
+        auto pos = _tail.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true)
+        {
+            slot = &_array[pos % Capacity];
+            const auto seq  = slot->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                // slot is free for this lap-race the other producers for it
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                // another producer already claimed pos-catch up with tail
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->value = value;
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* CONSUMER MEHOD: Frees slot for the next lap *after* removing element */
+    bool dequeue(NodeType& value)
+    {
+        Slot& slot = _array[_head % Capacity];
+        if (slot.seq.load(std::memory_order_acquire) != _head + 1)
+            return false; // empty (or claimed but not yet published)
+
+        value = slot.value;
+        slot.seq.store(_head + Capacity, std::memory_order_release);
+        ++_head;
+        return true;
+    }
+
+    /* CONSUMER MEHOD: Dequeues node without returning a value */
+    bool pop()
+    {
+        NodeType value;
+        return dequeue(value);
+    }
+
+     /* CONSUMER MEHOD: Returns a pointer to head *without* dequeueing it */
+    NodeType* peek()
+    {
+        if (is_empty())
+            return nullptr;
+
+        return &_array[_head % Capacity].value;
+    }
+
+    /* Snapshot of empty (consumer side) and full (producer side) status */
+    bool is_empty()
+    {
+        return _array[_head % Capacity].seq.load(std::memory_order_acquire) != _head + 1;
+    }
+    bool is_full()
+    {
+        const auto pos = _tail.load(std::memory_order_acquire);
+        const auto seq = _array[pos % Capacity].seq.load(std::memory_order_acquire);
+        return static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos) < 0;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> seq;
+        NodeType value;
+    };
+
+    Slot _array[Capacity];
+
+    // producers contend on tail-keep it away from the consumer's head
+    alignas(CacheLine) std::atomic<size_t> _tail;
+    alignas(CacheLine) size_t _head;
+};
@@ -0,0 +1,180 @@
+/* A multi-lane SPSC queue where every lane is an independent CircularBuffer.
+   Producer picks a lane per element, consumer drains lanes either by strict
+   priority (lane 0 first) or by weighted round robin.
+
+   A summary word holds one bit per lane that *may* be non-empty so the
+   consumer never probes lanes with nothing in them. Protocol:
+     producer: enqueue into lane, seq_cst fence, load summary and fetch_or
+               the lane bit *only* if it is clear
+     consumer: on finding a flagged lane empty fetch_and the bit away,
+               seq_cst fence, then re-check the lane
+   The paired fences mean either the producer's load sees the clear (and sets
+   the bit again) or the consumer's re-check sees the element, so an enqueue
+   can never be stranded behind a clear bit. While a lane stays busy the
+   producer only reads the summary word and never writes it-the summary and
+   the consumer's round robin state each sit on their own cache line. The
+   price is a full fence on every enqueue.
+
+   SUMMARY [0 1 1 0 ...]
+   LANE 0  [ ]
+   LANE 1  [x x x]
+   LANE 2  [x] */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "circular_buffer.h"
+
+
+enum class DrainPolicy {
+    Strict,     // always drain the lowest non-empty lane first
+    Weighted    // drain up to weight[lane] elements before moving on
+};
+
+template<typename NodeType, size_t Size, size_t Lanes,
+         DrainPolicy Policy = DrainPolicy::Strict>
+class PriorityCircularBuffer {
+public:
+    enum { CacheLine = 64 };
+    static_assert(Lanes > 0 && Lanes <= 64, "summary word holds at most 64 lanes");
+
+    PriorityCircularBuffer(): _summary{0}, _cursor{Lanes - 1}, _credit{0}
+    {
+        _weights.fill(1);
+    }
+
+    explicit PriorityCircularBuffer(const std::array<size_t, Lanes>& weights)
+        : _summary{0}, _weights{weights}, _cursor{Lanes - 1}, _credit{0}
+    {
+        // a zero weight would starve the lane forever-treat it as one
+        for (auto& weight : _weights)
+            weight = weight == 0 ? 1 : weight;
+    }
+
+    virtual ~PriorityCircularBuffer() {}
+
+    /* PRODUCER METHOD: Enqueues into lane and flags it in the summary word */
+    bool enqueue(const NodeType& value, size_t lane)
+    {
+        if (lane >= Lanes)
+            return false; // no such lane
+        if (!_lanes[lane].enqueue(value))
+            return false; // lane full
+
+        // pairs with the fence in visit-see the consumer's clear or be seen
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!(_summary.load(std::memory_order_relaxed) & lane_bit(lane)))
+            _summary.fetch_or(lane_bit(lane), std::memory_order_release);
+        return true;
+    }
+
+    /* CONSUMER MEHOD: Dequeues from the lane chosen by the drain policy */
+    bool dequeue(NodeType& value)
+    {
+        return visit([&](size_t lane) {
+            if (!_lanes[lane].dequeue(value))
+                return false;
+
+            if constexpr (Policy == DrainPolicy::Weighted)
+                --_credit;
+            return true;
+        });
+    }
+
+    /* CONSUMER MEHOD: Dequeues node without returning a value */
+    bool pop()
+    {
+        NodeType value;
+        return dequeue(value);
+    }
+
+    /* CONSUMER MEHOD: Returns a pointer to the element the next dequeue would
+       return *without* dequeueing it */
+    NodeType* peek()
+    {
+        NodeType* result = nullptr;
+        visit([&](size_t lane) {
+            result = _lanes[lane].peek();
+            return result != nullptr;
+        });
+        return result;
+    }
+
+    /* Snapshot of empty and full queue status */
+    bool is_empty()
+    {
+        for (auto& lane : _lanes)
+            if (!lane.is_empty())
+                return false;
+        return true;
+    }
+    // a lane that does not exist is always empty and can never take elements
+    bool is_empty(size_t lane)  { return lane >= Lanes || _lanes[lane].is_empty(); }
+    bool is_full(size_t lane)   { return lane >= Lanes || _lanes[lane].is_full(); }
+
+private:
+    static uint64_t lane_bit(size_t lane) { return uint64_t{1} << lane; }
+
+    /* CONSUMER METHOD: Applies op to lanes in drain order until it succeeds.
+       Lanes that turn out to be empty have their summary bit cleared. */
+    template<typename Op>
+    bool visit(Op&& op)
+    {
+        uint64_t mask = _summary.load(std::memory_order_acquire);
+        while (mask != 0)
+        {
+            const size_t lane = next_lane(mask);
+            if (op(lane))
+                return true;
+
+            // clear before re-checking-an enqueue racing with us either sees
+            // the clear and sets the bit again or is visible to the re-check
+            _summary.fetch_and(~lane_bit(lane), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (op(lane))
+            {
+                _summary.fetch_or(lane_bit(lane), std::memory_order_relaxed);
+                return true;
+            }
+            mask &= ~lane_bit(lane);
+        }
+        return false;
+    }
+
+    /* CONSUMER METHOD: Picks the next lane to drain out of a non-empty mask */
+    size_t next_lane(uint64_t mask)
+    {
+        if constexpr (Policy == DrainPolicy::Strict)
+        {
+            return std::countr_zero(mask);
+        }
+        else
+        {
+            if (_credit > 0 && (mask & lane_bit(_cursor)))
+                return _cursor;
+
+            // move on to the next flagged lane after the cursor, wrapping
+            const uint64_t after = _cursor + 1 < 64 ? mask & ~((lane_bit(_cursor) << 1) - 1) : 0;
+            _cursor = std::countr_zero(after != 0 ? after : mask);
+            _credit = _weights[_cursor];
+            return _cursor;
+        }
+    }
+
+    CircularBuffer<NodeType, Size> _lanes[Lanes];
+
+    // producer reads summary on every enqueue-keep it off the lanes' and the
+    // consumer's lines
+    alignas(CacheLine) std::atomic<uint64_t> _summary;
+
+    // consumer-only weighted round robin state-cursor starts on the last
+    // lane so the first pick wraps around to lane 0
+    alignas(CacheLine) std::array<size_t, Lanes> _weights;
+    size_t _cursor;
+    size_t _credit;
+};
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "../batch_queue.h"
+
+
+/* Shared interface tests live in circular_buffer.cc */
+
+TEST(BatchQueueTest, TestWrapAround)
+{
+    BatchQueue<int, 10, 4> q;
+    int item;
+    for (int i=0; i < 1000; i++) {
+        ASSERT_TRUE(q.enqueue(i));
+        if (i % 3 == 2) {
+            ASSERT_TRUE(q.enqueue(-i));
+            ASSERT_TRUE(q.dequeue(item));
+        }
+        ASSERT_TRUE(q.dequeue(item));
+    }
+
+    ASSERT_TRUE(q.is_empty());
+}
+
+TEST(BatchQueueTest, TestConcurrent)
+{
+    BatchQueue<int, 64> q;
+    const int MAX = 100000;
+    std::thread writer([&]() {
+        for (int i=0; i < MAX; i++) {
+            while (!q.enqueue(i))
+                std::this_thread::yield();
+        }
+    });
+
+    int item;
+    for (int i=0; i < MAX; i++) {
+        while (!q.dequeue(item))
+            std::this_thread::yield();
+        ASSERT_EQ(item, i);
+    }
+    writer.join();
+
+    ASSERT_TRUE(q.is_empty());
+}
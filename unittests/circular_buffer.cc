@@ -2,25 +2,38 @@
 #include <thread>
 
 #include "../circular_buffer.h"
+#include "../batch_queue.h"
+#include "../multi_producer_circular_buffer.h"
 
 
-TEST(CircularBufferTest, TestInitialize)
+/* Bounded queues sharing the CircularBuffer interface run the same suite */
+template<typename Q>
+class CircularBufferTest : public ::testing::Test {};
+
+using CircularBufferTypes = ::testing::Types<
+    CircularBuffer<int, 100>,
+    BatchQueue<int, 100>,
+    MultiProducerCircularBuffer<int, 100>
+>;
+TYPED_TEST_SUITE(CircularBufferTest, CircularBufferTypes);
+
+TYPED_TEST(CircularBufferTest, TestInitialize)
 {
-    CircularBuffer<int, 100> q;
+    TypeParam q;
     ASSERT_TRUE(q.is_empty());
 }
 
-TEST(CircularBufferTest, TestEnqueue)
+TYPED_TEST(CircularBufferTest, TestEnqueue)
 {
-    CircularBuffer<int, 100> q;
+    TypeParam q;
     q.enqueue(5);
     ASSERT_EQ(*q.peek(), 5);
     ASSERT_FALSE(q.is_empty());
 }
 
-TEST(CircularBufferTest, TestEnqueueMany)
+TYPED_TEST(CircularBufferTest, TestEnqueueMany)
 {
-    CircularBuffer<int, 100> q;
+    TypeParam q;
     for (int i=0; i < 100; i++) {
         q.enqueue(i);
     }
@@ -32,9 +45,9 @@ TEST(CircularBufferTest, TestEnqueueMany)
     }
 }
 
-TEST(CircularBufferTest, TestExcessEnqueue)
+TYPED_TEST(CircularBufferTest, TestExcessEnqueue)
 {
-    CircularBuffer<int, 100> q;
+    TypeParam q;
     for (int i=0; i < 101; i++) {
         q.enqueue(i);
     }
@@ -42,9 +55,9 @@ TEST(CircularBufferTest, TestExcessEnqueue)
     ASSERT_TRUE(q.is_full());
 }
 
-TEST(CircularBufferTest, TestDequeue)
+TYPED_TEST(CircularBufferTest, TestDequeue)
 {
-    CircularBuffer<int, 100> q;
+    TypeParam q;
     int item;
     ASSERT_FALSE(q.dequeue(item));
 
@@ -54,9 +67,9 @@ TEST(CircularBufferTest, TestDequeue)
     ASSERT_TRUE(q.is_empty());
 }
 
-TEST(CircularBufferTest, TestExcessDequeue)
+TYPED_TEST(CircularBufferTest, TestExcessDequeue)
 {
-    CircularBuffer<int, 100> q;
+    TypeParam q;
     for (int i=0; i < 100; i++) {
         q.enqueue(i);
     }
@@ -69,9 +82,9 @@ TEST(CircularBufferTest, TestExcessDequeue)
     ASSERT_TRUE(q.is_empty());
 }
 
-TEST(CircularBufferTest, TestPeek)
+TYPED_TEST(CircularBufferTest, TestPeek)
 {
-    CircularBuffer<int, 100> q;
+    TypeParam q;
     for (int i=0; i < 100; i++) {
         q.enqueue(i);
     }
@@ -86,9 +99,9 @@ TEST(CircularBufferTest, TestPeek)
     }
 }
 
-TEST(CircularBufferTest, TestThreading)
+TYPED_TEST(CircularBufferTest, TestThreading)
 {
-    CircularBuffer<int, 100> q;
+    TypeParam q;
     std::thread writer([&]() {
         for (int i=0; i < 100; i++) {
             q.enqueue(i);
@@ -97,7 +110,6 @@ TEST(CircularBufferTest, TestThreading)
     writer.join();
 
     std::thread reader([&]() {
-        int item;
         for (int i=0; i < 100; i++) {
             q.pop();
         }
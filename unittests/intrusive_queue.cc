@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "../intrusive_queue.h"
+
+
+struct Message : IntrusiveNode
+{
+    int value;
+
+    Message(): value{0} {}
+    Message(int val): value{val} {}
+};
+
+TEST(IntrusiveQueueTest, TestInitialize)
+{
+    IntrusiveQueue<Message> q;
+    ASSERT_TRUE(q.is_empty());
+    ASSERT_EQ(q.peek(), nullptr);
+}
+
+TEST(IntrusiveQueueTest, TestEnqueue)
+{
+    IntrusiveQueue<Message> q;
+    Message m{5};
+    q.enqueue(&m);
+    ASSERT_EQ(q.peek(), &m);
+    ASSERT_FALSE(q.is_empty());
+}
+
+TEST(IntrusiveQueueTest, TestEnqueueMany)
+{
+    IntrusiveQueue<Message> q;
+    std::vector<Message> pool(100);
+    for (int i=0; i < 100; i++) {
+        pool[i].value = i;
+        q.enqueue(&pool[i]);
+    }
+
+    Message* item;
+    for (int i=0; i < 100; i++) {
+        ASSERT_TRUE(q.dequeue(item));
+        ASSERT_EQ(item, &pool[i]); // no copies-caller gets its own object back
+        ASSERT_EQ(item->value, i);
+    }
+    ASSERT_TRUE(q.is_empty());
+}
+
+TEST(IntrusiveQueueTest, TestDequeue)
+{
+    IntrusiveQueue<Message> q;
+    Message* item;
+    ASSERT_FALSE(q.dequeue(item));
+
+    Message m{5};
+    q.enqueue(&m);
+    ASSERT_TRUE(q.dequeue(item));
+    ASSERT_EQ(item->value, 5);
+    ASSERT_TRUE(q.is_empty());
+    ASSERT_FALSE(q.dequeue(item));
+}
+
+TEST(IntrusiveQueueTest, TestReuseNode)
+{
+    IntrusiveQueue<Message> q;
+    Message m{5};
+    Message* item;
+    for (int i=0; i < 100; i++) {
+        q.enqueue(&m);
+        ASSERT_TRUE(q.dequeue(item));
+        ASSERT_EQ(item, &m);
+    }
+    ASSERT_TRUE(q.is_empty());
+}
+
+TEST(IntrusiveQueueTest, TestCopyAndMove)
+{
+    IntrusiveQueue<Message> q;
+    Message a{1};
+    Message b{2};
+    q.enqueue(&a);
+    q.enqueue(&b);
+
+    // copying a linked node does not copy its link
+    Message copy{a};
+    ASSERT_EQ(copy.value, 1);
+    ASSERT_EQ(copy.next.load(), nullptr);
+
+    Message moved{std::move(copy)};
+    ASSERT_EQ(moved.value, 1);
+    ASSERT_EQ(moved.next.load(), nullptr);
+
+    // assigning into a linked node keeps the queue intact
+    a = Message{3};
+    ASSERT_EQ(a.value, 3);
+
+    // a dequeued node keeps a stale link (to the stub) until it is reused,
+    // pool reallocation must not carry that link into the new storage
+    IntrusiveQueue<Message> links;
+    std::vector<Message> pool;
+    for (int i=0; i < 100; i++) {
+        pool.push_back(Message{i});
+        links.enqueue(&pool.back());
+        ASSERT_TRUE(links.pop());
+    }
+    pool.resize(pool.capacity() + 1); // always reallocates
+    for (int i=0; i < (int) pool.size(); i++) {
+        ASSERT_EQ(pool[i].value, i < 100 ? i : 0);
+        ASSERT_EQ(pool[i].next.load(), nullptr);
+    }
+
+    Message* item;
+    ASSERT_TRUE(q.dequeue(item));
+    ASSERT_EQ(item, &a);
+    ASSERT_TRUE(q.dequeue(item));
+    ASSERT_EQ(item, &b);
+    ASSERT_TRUE(q.is_empty());
+}
+
+TEST(IntrusiveQueueTest, TestPeek)
+{
+    IntrusiveQueue<Message> q;
+    std::vector<Message> pool(100);
+    for (int i=0; i < 100; i++) {
+        pool[i].value = i;
+        q.enqueue(&pool[i]);
+    }
+
+    for (int i=0; i < 100; i++) {
+        ASSERT_EQ(q.peek()->value, i);
+        ASSERT_TRUE(q.pop());
+    }
+    ASSERT_EQ(q.peek(), nullptr);
+}
+
+TEST(IntrusiveQueueTest, TestMultipleProducers)
+{
+    IntrusiveQueue<Message> q;
+    const int PRODUCERS = 4;
+    const int MAX = 10000;
+    std::vector<Message> pool(PRODUCERS * MAX);
+
+    std::vector<std::thread> writers;
+    for (int p=0; p < PRODUCERS; p++) {
+        writers.emplace_back([&, p]() {
+            for (int i=0; i < MAX; i++) {
+                Message& m = pool[p * MAX + i];
+                m.value = p * MAX + i;
+                q.enqueue(&m);
+            }
+        });
+    }
+
+    // each producer's messages arrive in the order they were sent
+    std::vector<int> last(PRODUCERS, -1);
+    Message* item;
+    for (int i=0; i < PRODUCERS * MAX; i++) {
+        while (!q.dequeue(item))
+            std::this_thread::yield();
+        int producer = item->value / MAX;
+        ASSERT_GT(item->value, last[producer]);
+        last[producer] = item->value;
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    ASSERT_TRUE(q.is_empty());
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "../multi_producer_circular_buffer.h"
+
+
+/* Shared interface tests live in circular_buffer.cc */
+
+TEST(MultiProducerCircularBufferTest, TestWrapAround)
+{
+    MultiProducerCircularBuffer<int, 10> q;
+    int item;
+    for (int i=0; i < 1000; i++) {
+        ASSERT_TRUE(q.enqueue(i));
+        ASSERT_TRUE(q.dequeue(item));
+        ASSERT_EQ(item, i);
+    }
+
+    ASSERT_TRUE(q.is_empty());
+}
+
+TEST(MultiProducerCircularBufferTest, TestSmallCapacity)
+{
+    MultiProducerCircularBuffer<int, 2> q;
+    ASSERT_TRUE(q.enqueue(1));
+    ASSERT_TRUE(q.enqueue(2));
+    ASSERT_FALSE(q.enqueue(3)); // must not overwrite an unconsumed slot
+    ASSERT_TRUE(q.is_full());
+
+    int item;
+    for (int i=0; i < 100; i++) {
+        ASSERT_TRUE(q.dequeue(item));
+        ASSERT_EQ(item, i + 1);
+        ASSERT_TRUE(q.enqueue(i + 3));
+        ASSERT_TRUE(q.is_full());
+    }
+}
+
+TEST(MultiProducerCircularBufferTest, TestMultipleProducers)
+{
+    MultiProducerCircularBuffer<int, 64> q;
+    const int PRODUCERS = 4;
+    const int MAX = 10000;
+
+    std::vector<std::thread> writers;
+    for (int p=0; p < PRODUCERS; p++) {
+        writers.emplace_back([&, p]() {
+            for (int i=0; i < MAX; i++) {
+                while (!q.enqueue(p * MAX + i))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    // each producer's elements arrive in the order they were sent
+    std::vector<int> last(PRODUCERS, -1);
+    int item;
+    for (int i=0; i < PRODUCERS * MAX; i++) {
+        while (!q.dequeue(item))
+            std::this_thread::yield();
+        int producer = item / MAX;
+        ASSERT_GT(item, last[producer]);
+        last[producer] = item;
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    ASSERT_TRUE(q.is_empty());
+}
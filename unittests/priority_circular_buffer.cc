@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "../priority_circular_buffer.h"
+
+
+TEST(PriorityCircularBufferTest, TestInitialize)
+{
+    PriorityCircularBuffer<int, 100, 4> q;
+    ASSERT_TRUE(q.is_empty());
+    ASSERT_EQ(q.peek(), nullptr);
+}
+
+TEST(PriorityCircularBufferTest, TestEnqueue)
+{
+    PriorityCircularBuffer<int, 100, 4> q;
+    q.enqueue(5, 2);
+    ASSERT_EQ(*q.peek(), 5);
+    ASSERT_FALSE(q.is_empty());
+    ASSERT_FALSE(q.is_empty(2));
+    ASSERT_TRUE(q.is_empty(0));
+}
+
+TEST(PriorityCircularBufferTest, TestExcessEnqueue)
+{
+    PriorityCircularBuffer<int, 100, 4> q;
+    for (int i=0; i < 100; i++) {
+        ASSERT_TRUE(q.enqueue(i, 1));
+    }
+
+    ASSERT_FALSE(q.enqueue(100, 1));
+    ASSERT_TRUE(q.is_full(1));
+    ASSERT_TRUE(q.enqueue(100, 0)); // other lanes are unaffected
+}
+
+TEST(PriorityCircularBufferTest, TestInvalidLane)
+{
+    PriorityCircularBuffer<int, 100, 4> q;
+    ASSERT_FALSE(q.enqueue(5, 4));
+    ASSERT_FALSE(q.enqueue(5, 64));
+    ASSERT_TRUE(q.is_empty());
+    ASSERT_TRUE(q.is_empty(4));
+    ASSERT_TRUE(q.is_full(4));
+}
+
+TEST(PriorityCircularBufferTest, TestDequeue)
+{
+    PriorityCircularBuffer<int, 100, 4> q;
+    int item;
+    ASSERT_FALSE(q.dequeue(item));
+
+    q.enqueue(5, 3);
+    ASSERT_TRUE(q.dequeue(item));
+    ASSERT_EQ(item, 5);
+    ASSERT_TRUE(q.is_empty());
+    ASSERT_FALSE(q.dequeue(item));
+}
+
+TEST(PriorityCircularBufferTest, TestStrictPriority)
+{
+    PriorityCircularBuffer<int, 100, 3> q;
+    for (int i=0; i < 10; i++) {
+        q.enqueue(200 + i, 2);
+    }
+    for (int i=0; i < 10; i++) {
+        q.enqueue(100 + i, 1);
+    }
+    q.enqueue(0, 0);
+
+    int item;
+    ASSERT_EQ(*q.peek(), 0);
+    ASSERT_TRUE(q.dequeue(item));
+    ASSERT_EQ(item, 0);
+    for (int i=0; i < 10; i++) {
+        ASSERT_TRUE(q.dequeue(item));
+        ASSERT_EQ(item, 100 + i);
+    }
+
+    q.enqueue(1, 0); // urgent element jumps the remaining bulk traffic
+    ASSERT_TRUE(q.dequeue(item));
+    ASSERT_EQ(item, 1);
+    for (int i=0; i < 10; i++) {
+        ASSERT_TRUE(q.dequeue(item));
+        ASSERT_EQ(item, 200 + i);
+    }
+    ASSERT_TRUE(q.is_empty());
+}
+
+TEST(PriorityCircularBufferTest, TestWeighted)
+{
+    PriorityCircularBuffer<int, 100, 2, DrainPolicy::Weighted> q({3, 1});
+    for (int i=0; i < 6; i++) {
+        q.enqueue(i, 0);
+        q.enqueue(100 + i, 1);
+    }
+
+    int expected[] = {0, 1, 2, 100, 3, 4, 5, 101, 102, 103, 104, 105};
+    int item;
+    for (int i=0; i < 12; i++) {
+        ASSERT_EQ(*q.peek(), expected[i]);
+        ASSERT_TRUE(q.dequeue(item));
+        ASSERT_EQ(item, expected[i]);
+    }
+    ASSERT_TRUE(q.is_empty());
+}
+
+TEST(PriorityCircularBufferTest, TestThreading)
+{
+    PriorityCircularBuffer<int, 64, 4> q;
+    const int MAX = 100000;
+    std::thread writer([&]() {
+        for (int i=0; i < MAX; i++) {
+            while (!q.enqueue(i, i % 4))
+                std::this_thread::yield();
+        }
+    });
+
+    // elements within a lane keep their order
+    int last[4] = {-1, -1, -1, -1};
+    int item;
+    for (int i=0; i < MAX; i++) {
+        while (!q.dequeue(item))
+            std::this_thread::yield();
+        ASSERT_GT(item, last[item % 4]);
+        last[item % 4] = item;
+    }
+    writer.join();
+
+    ASSERT_TRUE(q.is_empty());
+}